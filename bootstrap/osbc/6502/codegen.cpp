@@ -82,7 +82,7 @@ void CodeGen::Visit(ast::PReferenceNode node)
 
 void CodeGen::Visit(ast::PConstantExpressionNode node)
 {
-    fmt::println("  LDC {0}", node->GetToken().literal);
+    fmt::println("  LDC {0}", node->GetToken().literal());
 }
 
 /*************************************************************************/
@@ -94,7 +94,7 @@ void CodeGen::Visit(ast::PReferenceExpressionNode node)
     if (node->IsConstant())
         op = "LDC";
 
-    fmt::println("  {0} {1}", op, node->GetReference()->GetIdent().literal);
+    fmt::println("  {0} {1}", op, node->GetReference()->GetIdent().literal());
 }
 
 /*************************************************************************/
@@ -155,7 +155,7 @@ void CodeGen::Visit(ast::PCompoundStatementNode node)
 void CodeGen::Visit(ast::PAssignmentStatementNode node)
 {
     node->GetExpression()->Accept(*this);
-    fmt::println("  STV {0}", node->GetReference()->GetIdent().literal);
+    fmt::println("  STV {0}", node->GetReference()->GetIdent().literal());
 }
 
 /*************************************************************************/
@@ -165,7 +165,7 @@ void CodeGen::Visit(ast::PCallStatementNode node)
     for (auto param : node->GetParameters())
         param->Accept(*this);
 
-    fmt::println("  JSR {0}", node->GetReference()->GetIdent().literal);
+    fmt::println("  JSR {0}", node->GetReference()->GetIdent().literal());
 }
 
 /*************************************************************************/
@@ -254,7 +254,7 @@ void CodeGen::Visit(ast::PParameterDeclNode node)
 
 void CodeGen::Visit(ast::PFunctionNode node)
 {
-    fmt::println("{0}:", node->GetIdent().literal);
+    fmt::println("{0}:", node->GetIdent().literal());
 
     m_symbolTable = node->GetSymbolTable();
 
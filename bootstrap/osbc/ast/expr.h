@@ -66,7 +66,7 @@ namespace ast
 
     public:
         /* constructor */ ReferenceNode(private_tag__, Token ident)
-            : Node(ident.lineNumber)
+            : Node(ident.lineNumber())
             , m_ident(ident)
         {
         }
@@ -78,10 +78,13 @@ namespace ast
 
         const Token &GetIdent() const { return m_ident; }
 
+        /// @brief Interned name being referenced.
+        Atom GetAtom() const { return m_ident.atom; }
+
         // TODO: Create fully qualified name later.
-        std::string GetFullName() const { return m_ident.literal; }
+        std::string_view GetFullName() const { return AtomTable::Text(m_ident.atom); }
 
-        std::string ToString() const { return GetFullName(); }
+        std::string ToString() const { return std::string(GetFullName()); }
     };
 
     /****************************************************************/
@@ -97,7 +100,7 @@ namespace ast
 
     public:
         ConstantExpressionNode(private_tag__, Token token)
-            : ExpressionNode(token.lineNumber)
+            : ExpressionNode(token.lineNumber())
             , m_token(token)
         {
         }
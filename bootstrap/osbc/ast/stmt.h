@@ -62,7 +62,7 @@ namespace ast
             Token ident,
             PReferenceNode type,
             PExpressionNode initializer = nullptr)
-            : StatementNode(ident.lineNumber)
+            : StatementNode(ident.lineNumber())
             , DeclNode(ident, type)
             , m_isConst(isConst)
             , m_initializer(initializer)
@@ -107,7 +107,7 @@ namespace ast
             PassByType passBy,
             Token ident,
             PReferenceNode type)
-            : Node(ident.lineNumber)
+            : Node(ident.lineNumber())
             , DeclNode(ident, type)
             , m_passBy(passBy)
             , codeGen(nullptr)
@@ -158,7 +158,7 @@ namespace ast
             std::vector<PParameterDeclNode> parameters,
             PReferenceNode returnType, 
             const PCompoundStatementNode &body)
-            : TLStatementNode(ident.lineNumber)
+            : TLStatementNode(ident.lineNumber())
             , DeclNode(ident, returnType)
             , m_parameters(parameters)
             , m_symbolTable()
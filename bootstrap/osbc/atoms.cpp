@@ -0,0 +1,267 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#include "bootstrap.h"
+#include "atoms.h"
+#include "keywords.h"
+
+#include <bit>
+#include <mutex>
+
+/*************************************************************************/
+/*************************************************************************/
+
+namespace
+{
+    // An atom is (slot << ShardBits) | shard.
+    constexpr size_t ShardBits = 4;
+    constexpr size_t ShardCount = size_t(1) << ShardBits;
+
+    /*
+     * Each shard's slots live in segments that double in size, so the
+     * table of segments never moves and readers need no lock.
+     */
+    constexpr size_t SegmentBaseBits = 8;
+    constexpr size_t SegmentCount = 32 - ShardBits - SegmentBaseBits + 1;
+    constexpr size_t MaxSlots = size_t(1) << (32 - ShardBits);
+
+    // Names are copied in to blocks of this size.
+    constexpr size_t TextBlockSize = 64 * 1024;
+
+    // Size of each thread's cache of recently interned names.
+    constexpr size_t CacheSize = 4096;
+
+    struct CacheEntry
+    {
+        std::string_view text;
+        Atom atom = AtomTable::NullAtom;
+    };
+
+    inline size_t Hash(std::string_view text)
+    {
+        // FNV-1a, names are short so this beats anything fancier.
+        size_t hash = 0xcbf29ce484222325ull;
+
+        for (char c : text)
+            hash = (hash ^ static_cast<uchar>(c)) * 0x100000001b3ull;
+
+        return hash;
+    }
+
+    inline size_t SegmentOf(size_t slot)
+    {
+        return std::bit_width((slot >> SegmentBaseBits) + 1) - 1;
+    }
+
+    inline size_t SegmentStart(size_t segment)
+    {
+        return ((size_t(1) << segment) - 1) << SegmentBaseBits;
+    }
+}
+
+/*************************************************************************/
+
+struct AtomTable::Shard
+{
+    std::mutex lock;
+
+    /*
+     * Open addressed hash of the shard's atoms, linear probing.  Each entry
+     * keeps a few hash bits to skip most text compares.
+     */
+    struct Entry
+    {
+        std::uint32_t hash;
+        Atom atom;
+    };
+
+    std::vector<Entry> index;
+
+    size_t slots = 0;
+    std::unique_ptr<std::string_view[]> segments[SegmentCount];
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char *blockNext = nullptr;
+    size_t blockLeft = 0;
+
+    std::string_view Store(std::string_view text)
+    {
+        if (text.size() > blockLeft)
+        {
+            size_t size = std::max(text.size(), TextBlockSize);
+
+            blocks.push_back(std::make_unique<char[]>(size));
+            blockNext = blocks.back().get();
+            blockLeft = size;
+        }
+
+        std::copy(text.begin(), text.end(), blockNext);
+
+        std::string_view rval(blockNext, text.size());
+
+        blockNext += text.size();
+        blockLeft -= text.size();
+
+        return rval;
+    }
+
+    std::string_view &Slot(size_t slot)
+    {
+        size_t segment = SegmentOf(slot);
+        return segments[segment][slot - SegmentStart(segment)];
+    }
+
+    /// @brief Find the entry for the text, or the empty entry it would go in.
+    Entry &Probe(std::string_view text, size_t hash)
+    {
+        size_t mask = index.size() - 1;
+        auto check = static_cast<std::uint32_t>(hash >> 32);
+
+        for (size_t i = (hash >> ShardBits) & mask; ; i = (i + 1) & mask)
+        {
+            Entry &entry = index[i];
+
+            if (entry.atom == NullAtom)
+                return entry;
+
+            if (entry.hash == check && Slot(entry.atom >> ShardBits) == text)
+                return entry;
+        }
+    }
+
+    void Grow()
+    {
+        std::vector<Entry> old(index.size() * 2);
+        old.swap(index);
+
+        size_t mask = index.size() - 1;
+
+        for (const Entry &entry : old)
+        {
+            if (entry.atom == NullAtom)
+                continue;
+
+            size_t hash = Hash(Slot(entry.atom >> ShardBits));
+            size_t i = (hash >> ShardBits) & mask;
+
+            while (index[i].atom != NullAtom)
+                i = (i + 1) & mask;
+
+            index[i] = entry;
+        }
+    }
+};
+
+/*************************************************************************/
+
+AtomTable::Shard &AtomTable::GetShard(size_t index)
+{
+    // Never freed; names can still be looked up while statics are torn down.
+    static Shard *s_shards = [] ()
+    {
+        Shard *shards = new Shard[ShardCount];
+
+        for (size_t i = 0; i < ShardCount; ++i)
+            shards[i].index.resize(1024);
+
+        shards[0].slots = 1; // Slot 0 of shard 0 is NullAtom.
+        shards[0].segments[0] = std::make_unique<std::string_view[]>(size_t(1) << SegmentBaseBits);
+
+        return shards;
+    }();
+
+    return s_shards[index];
+}
+
+/*************************************************************************/
+
+Atom AtomTable::Intern(std::string_view text)
+{
+    /*
+     * Most names are used over and over, so each thread remembers the ones
+     * it has seen recently and only takes a shard lock on a miss.
+     */
+    thread_local std::array<CacheEntry, CacheSize> s_cache;
+
+    size_t hash = Hash(text);
+    CacheEntry &cached = s_cache[(hash >> ShardBits) & (CacheSize - 1)];
+
+    if (cached.atom != NullAtom && cached.text == text)
+        return cached.atom;
+
+    size_t shardIndex = hash & (ShardCount - 1);
+    Shard &shard = GetShard(shardIndex);
+
+    std::lock_guard lock(shard.lock);
+
+    Shard::Entry *entry = &shard.Probe(text, hash);
+
+    if (entry->atom != NullAtom)
+    {
+        cached = { shard.Slot(entry->atom >> ShardBits), entry->atom };
+        return entry->atom;
+    }
+
+    if (shard.slots >= MaxSlots)
+        throw std::runtime_error("Too many distinct identifiers.");
+
+    size_t slot = shard.slots++;
+    size_t segment = SegmentOf(slot);
+
+    if (!shard.segments[segment])
+        shard.segments[segment] = std::make_unique<std::string_view[]>(size_t(1) << (segment + SegmentBaseBits));
+
+    std::string_view stored = shard.Store(text);
+    Atom atom = static_cast<Atom>((slot << ShardBits) | shardIndex);
+
+    shard.Slot(slot) = stored;
+
+    *entry = { static_cast<std::uint32_t>(hash >> 32), atom };
+
+    // Keep the index at most half full.
+    if (slot * 2 >= shard.index.size())
+        shard.Grow();
+
+    cached = { stored, atom };
+
+    return atom;
+}
+
+/*************************************************************************/
+
+Atom AtomTable::Find(std::string_view text)
+{
+    size_t hash = Hash(text);
+    Shard &shard = GetShard(hash & (ShardCount - 1));
+
+    std::lock_guard lock(shard.lock);
+
+    return shard.Probe(text, hash).atom;
+}
+
+/*************************************************************************/
+
+std::string_view AtomTable::Text(Atom atom)
+{
+    Shard &shard = GetShard(atom & (ShardCount - 1));
+    return shard.Slot(atom >> ShardBits);
+}
+
+/*************************************************************************/
+
+Atom AtomTable::Keyword(size_t index)
+{
+    static const auto s_keywords = [] ()
+    {
+        std::array<Atom, keywords::All.size()> rval;
+
+        for (size_t i = 0; i < keywords::All.size(); ++i)
+            rval[i] = Intern(keywords::All[i].spelling);
+
+        return rval;
+    }();
+
+    return s_keywords[index];
+}
+
+/*************************************************************************/
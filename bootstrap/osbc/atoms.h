@@ -0,0 +1,56 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#ifndef OS_ATOMS_H__
+#define OS_ATOMS_H__
+
+/*************************************************************************/
+
+#include "bootstrap.h"
+
+/*************************************************************************/
+
+/// @brief A small integer standing in for an interned identifier.
+typedef std::uint32_t Atom;
+
+/**
+ * @brief Compilation wide table of interned identifiers.
+ *
+ * @details
+ * Every distinct name is stored once and given an Atom; the same text
+ * always gets the same atom, so names can be compared and hashed as
+ * integers.  Atom 0 (NullAtom) is never handed out.
+ *
+ * The table is split into shards by hash, each with its own lock, so
+ * several lexers can intern names at the same time.  Atoms and their text
+ * live until the process exits.
+ */
+class AtomTable
+{
+private:
+    AtomTable() = delete;
+
+    struct Shard;
+    static Shard &GetShard(size_t index);
+
+public:
+    static constexpr Atom NullAtom = 0;
+
+    /// @brief Get the atom for the given text, adding it if it is new.
+    static Atom Intern(std::string_view text);
+
+    /// @brief Get the atom for the given text, or NullAtom if it was never interned.
+    static Atom Find(std::string_view text);
+
+    /// @brief The text of an atom; empty for NullAtom.
+    static std::string_view Text(Atom atom);
+
+    /// @brief Atom of the reserved word at the given index in keywords::All.
+    static Atom Keyword(size_t index);
+};
+
+/*************************************************************************/
+
+#endif /* OS_ATOMS_H__ */
+
+/*************************************************************************/
@@ -0,0 +1,162 @@
+/*************************************************************************/
+/*************************************************************************/
+/*
+ * Micro benchmark comparing keywords::Lookup() against the std::map the
+ * lexer used to search for every word it read.
+ *
+ * usage: osbc_bench_keywords [file.os] [passes]
+ *
+ * Without a file an identifier heavy corpus is generated.
+ */
+/*************************************************************************/
+
+#include "bootstrap.h"
+#include "keywords.h"
+
+#include <chrono>
+#include <random>
+
+/*************************************************************************/
+
+namespace
+{
+    const std::map<std::string, Token::Type> s_keywordMap = []()
+    {
+        std::map<std::string, Token::Type> rval;
+
+        for (const keywords::Keyword &kw : keywords::All)
+            rval.emplace(kw.spelling, kw.type);
+
+        return rval;
+    }();
+
+    /****************************************************************/
+
+    std::string ReadCorpus(const std::string &filename)
+    {
+        std::ifstream file(filename, std::ios::in | std::ios::binary);
+
+        if (file.fail())
+            throw std::runtime_error(fmt::format("Unable to open file '{0}' for reading.", filename));
+
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    /****************************************************************/
+
+    std::string GenerateCorpus()
+    {
+        const char *idents[] = { "a", "b", "value", "count", "index", "result", "in_range", "buffer", "x1", "forEach", "whilst", "intValue" };
+
+        std::mt19937 rng(1234);
+        std::string rval;
+
+        for (int i = 0; i < 2'000'000; ++i)
+        {
+            // Roughly one word in four is a keyword.
+            if ((rng() % 4) == 0)
+                rval += keywords::All[rng() % keywords::All.size()].spelling;
+            else
+                rval += idents[rng() % std::size(idents)];
+
+            rval += ' ';
+        }
+
+        return rval;
+    }
+
+    /****************************************************************/
+
+    std::vector<std::string_view> SplitWords(std::string_view text)
+    {
+        std::vector<std::string_view> rval;
+        size_t i = 0;
+
+        while (i < text.size())
+        {
+            if (!isalpha((uchar)text[i]) && text[i] != '_')
+            {
+                ++i;
+                continue;
+            }
+
+            size_t start = i;
+
+            while (i < text.size() && (isalnum((uchar)text[i]) || text[i] == '_'))
+                ++i;
+
+            rval.push_back(text.substr(start, i - start));
+        }
+
+        return rval;
+    }
+
+    /****************************************************************/
+
+    template <typename F>
+    double Time(const std::vector<std::string_view> &words, int passes, size_t *found, F lookup)
+    {
+        size_t count = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int p = 0; p < passes; ++p)
+        {
+            for (std::string_view w : words)
+                count += lookup(w) != Token::Type::IDENT;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+
+        *found = count;
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+}
+
+/*************************************************************************/
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        std::string corpus = argc > 1 ? ReadCorpus(argv[1]) : GenerateCorpus();
+        int passes = argc > 2 ? std::stoi(argv[2]) : 10;
+
+        auto words = SplitWords(corpus);
+
+        if (words.empty())
+            throw std::runtime_error("Corpus contains no words.");
+
+        size_t mapFound, switchFound;
+
+        double mapNs = Time(words, passes, &mapFound, [] (std::string_view w)
+        {
+            // This is what GetWord() used to do: build a string then search the tree.
+            auto itr = s_keywordMap.find(std::string(w));
+            return itr != s_keywordMap.end() ? itr->second : Token::Type::IDENT;
+        });
+
+        double switchNs = Time(words, passes, &switchFound, [] (std::string_view w)
+        {
+            return keywords::Lookup(w);
+        });
+
+        if (mapFound != switchFound)
+            throw std::logic_error("BUG: Lookups disagree on the keyword count.");
+
+        double lookups = static_cast<double>(words.size()) * passes;
+
+        fmt::println("words: {0}, keywords: {1}, passes: {2}", words.size(), mapFound / passes, passes);
+        fmt::println("std::map         : {0:8.2f} ns/word", mapNs / lookups);
+        fmt::println("keywords::Lookup : {0:8.2f} ns/word", switchNs / lookups);
+        fmt::println("speed up         : {0:8.2f}x", mapNs / switchNs);
+    }
+    catch (const std::exception &ex)
+    {
+        fmt::println(stderr, "EXCEPTION: {0}", ex.what());
+        return -1;
+    }
+
+    return 0;
+}
+
+/*************************************************************************/
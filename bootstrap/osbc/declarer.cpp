@@ -84,14 +84,14 @@ void Declarer::LoadBuiltIns()
 
 void Declarer::VerifyUndefined(const Token &ident, Scoping scoping /* = Scoping::Normal */)
 {
-    auto decl = m_symbolTable->Find(ident.literal, scoping);
+    auto decl = m_symbolTable->Find(ident.atom, scoping);
 
     if (decl)
     {
         throw compile_error(
-            ident.lineNumber,
+            ident.lineNumber(),
             "Symbol '{0}' already defined.  (See previous definition on line {1})", 
-            ident.literal, 
+            ident.literal(), 
             decl->lineNumber);
     }
 }
@@ -241,7 +241,7 @@ void Declarer::Visit(ast::PImportNode node)
     // TODO: Add import here.
     Token ident = node.GetReference()->GetIdent();
     
-    fmt::print("Importing {0}\r\n", ident.literal);
+    fmt::print("Importing {0}\r\n", ident.literal());
 #endif
 }
 
@@ -0,0 +1,249 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#ifndef OS_KEYWORDS_H__
+#define OS_KEYWORDS_H__
+
+/*************************************************************************/
+
+#include "token.h"
+
+/*************************************************************************/
+
+namespace keywords
+{
+    /****************************************************************/
+
+    struct Keyword
+    {
+        std::string_view spelling;
+        Token::Type type;
+    };
+
+    /// @brief Every reserved word, used to check Lookup() at compile time.
+    constexpr std::array<Keyword, 31> All =
+    {{
+        { "_"        , Token::Type::DISCARD    },
+        { "if"       , Token::Type::IF         },
+        { "in"       , Token::Type::IN         },
+        { "int"      , Token::Type::INT        },
+        { "for"      , Token::Type::FOR        },
+        { "out"      , Token::Type::OUT        },
+        { "ref"      , Token::Type::REF        },
+        { "set"      , Token::Type::SET        },
+        { "var"      , Token::Type::VAR        },
+        { "base"     , Token::Type::BASE_REF   },
+        { "bool"     , Token::Type::BOOL       },
+        { "char"     , Token::Type::CHAR       },
+        { "else"     , Token::Type::ELSE       },
+        { "enum"     , Token::Type::ENUM       },
+        { "null"     , Token::Type::NULL_CONST },
+        { "this"     , Token::Type::THIS_REF   },
+        { "true"     , Token::Type::BOOL_CONST },
+        { "void"     , Token::Type::VOID       },
+        { "break"    , Token::Type::BREAK      },
+        { "class"    , Token::Type::CLASS      },
+        { "const"    , Token::Type::CONST      },
+        { "false"    , Token::Type::BOOL_CONST },
+        { "while"    , Token::Type::WHILE      },
+        { "export"   , Token::Type::EXPORT     },
+        { "import"   , Token::Type::IMPORT     },
+        { "return"   , Token::Type::RETURN     },
+        { "string"   , Token::Type::STRING     },
+        { "switch"   , Token::Type::SWITCH     },
+        { "continue" , Token::Type::CONTINUE   },
+        { "function" , Token::Type::FUNCTION   },
+        { "interface", Token::Type::INTERFACE  }
+    }};
+
+    /****************************************************************/
+
+    /// @brief Compare the tail of a word against a keyword, the first character is already known to match.
+    template <size_t N>
+    constexpr bool Rest(const char *text, const char (&word)[N])
+    {
+        for (size_t i = 1; i < N - 1; ++i)
+        {
+            if (text[i] != word[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    /****************************************************************/
+
+    /// @brief Index of a keyword's spelling in All.
+    consteval int IndexOf(std::string_view spelling)
+    {
+        for (size_t i = 0; i < All.size(); ++i)
+        {
+            if (All[i].spelling == spelling)
+                return static_cast<int>(i);
+        }
+
+        throw "Not a keyword";
+    }
+
+    /****************************************************************/
+    /**
+     * @brief Recognise a reserved word directly from the source bytes.
+     *
+     * @details
+     * Dispatches on the length of the word and then its first character, so
+     * at most one keyword is ever compared against, and nothing allocates.
+     *
+     * @returns The keyword's index in All, or -1 for an identifier.
+     */
+    constexpr int Find(const char *text, size_t length)
+    {
+#define KW(W_) return Rest(text, W_) ? IndexOf(W_) : -1
+
+        switch (length)
+        {
+        case 1:
+            return text[0] == '_' ? IndexOf("_") : -1;
+
+        case 2:
+            if (text[0] != 'i')
+                break;
+
+            if (text[1] == 'f') return IndexOf("if");
+            if (text[1] == 'n') return IndexOf("in");
+            break;
+
+        case 3:
+            switch (text[0])
+            {
+            case 'f': KW("for");
+            case 'i': KW("int");
+            case 'o': KW("out");
+            case 'r': KW("ref");
+            case 's': KW("set");
+            case 'v': KW("var");
+            }
+            break;
+
+        case 4:
+            switch (text[0])
+            {
+            case 'b':
+                if (text[1] == 'a') KW("base");
+                KW("bool");
+
+            case 'c': KW("char");
+
+            case 'e':
+                if (text[1] == 'l') KW("else");
+                KW("enum");
+
+            case 'n': KW("null");
+
+            case 't':
+                if (text[1] == 'h') KW("this");
+                KW("true");
+
+            case 'v': KW("void");
+            }
+            break;
+
+        case 5:
+            switch (text[0])
+            {
+            case 'b': KW("break");
+
+            case 'c':
+                if (text[1] == 'l') KW("class");
+                KW("const");
+
+            case 'f': KW("false");
+            case 'w': KW("while");
+            }
+            break;
+
+        case 6:
+            switch (text[0])
+            {
+            case 'e': KW("export");
+            case 'i': KW("import");
+            case 'r': KW("return");
+
+            case 's':
+                if (text[1] == 't') KW("string");
+                KW("switch");
+            }
+            break;
+
+        case 8:
+            switch (text[0])
+            {
+            case 'c': KW("continue");
+            case 'f': KW("function");
+            }
+            break;
+
+        case 9:
+            if (text[0] == 'i')
+                KW("interface");
+            break;
+        }
+
+#undef KW
+
+        return -1;
+    }
+
+    /****************************************************************/
+
+    /// @brief Recognise a reserved word, returns its token type or Token::Type::IDENT.
+    constexpr Token::Type Lookup(const char *text, size_t length)
+    {
+        int index = Find(text, length);
+        return index < 0 ? Token::Type::IDENT : All[index].type;
+    }
+
+    /****************************************************************/
+
+    constexpr Token::Type Lookup(std::string_view word)
+    {
+        return Lookup(word.data(), word.size());
+    }
+
+    /****************************************************************/
+
+    constexpr bool Verify()
+    {
+        for (const Keyword &kw : All)
+        {
+            if (Lookup(kw.spelling) != kw.type)
+                return false;
+
+            // Changing the last character must turn it back into an identifier.
+            char changed[16] = {};
+
+            for (size_t i = 0; i < kw.spelling.size(); ++i)
+                changed[i] = kw.spelling[i];
+
+            changed[kw.spelling.size() - 1] = 'X';
+
+            if (Lookup(changed, kw.spelling.size()) != Token::Type::IDENT)
+                return false;
+        }
+
+        return
+            Lookup("iff") == Token::Type::IDENT &&
+            Lookup("vars") == Token::Type::IDENT &&
+            Lookup("Function") == Token::Type::IDENT &&
+            Lookup("interfaces") == Token::Type::IDENT;
+    }
+
+    static_assert(Verify(), "Keyword lookup does not agree with the keyword list.");
+
+    /****************************************************************/
+}
+
+/*************************************************************************/
+
+#endif /* OS_KEYWORDS_H__ */
+
+/*************************************************************************/
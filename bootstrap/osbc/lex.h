@@ -7,6 +7,7 @@
 /*************************************************************************/
 
 #include "bootstrap.h"
+#include "source.h"
 #include "token.h"
 
 /*************************************************************************/
@@ -33,8 +34,12 @@ public:
     };
 
 private:
-    std::istream *m_file;
-    bool m_ownFile;
+    PSourceBuffer m_source;
+
+    const char *m_data;    // Start of the source text (NUL terminated).
+    size_t m_size;         // Length of the source text.
+    size_t m_position;     // Where in the text we currently are.
+    std::uint32_t m_fileId; // Id of m_source, stamped on every token.
 
     std::stack<Token> m_backlog; // Pushed back tokens.
 
@@ -44,52 +49,23 @@ private:
     /// @brief The next token that will be returned by the lexer.
     Token m_lookAhead;
 
-    std::string m_line;  // Last read line from the file.
-    size_t m_position;   // Where in the line we currently are.
-    int m_lineNumber; // The current line number we're on.
-
-    bool m_eof; // Set when we have reached the end of the file.
-
-    void ReadLine(); // Read another line from the file
-
-    // Advance m_position while predicate returns true.
-    void ReadChars(std::function<bool (int)> predicate);
-
     void SkipWhiteSpace();
 
     inline
-    Token Result(size_t start, Token::Type type) const
-    {
-        std::string_view view(m_line);
-        return Token(m_lineNumber, view.substr(start, m_position - start), type);
-    }
-
-    inline
-    Token Error(size_t start, ErrorCode error) const
+    Token Result(size_t start, Token::Type type, Atom atom = AtomTable::NullAtom) const
     {
-        (void)error;
-        return Result(start, Token::Type::ERROR);
+        return Token
+        {
+            type,
+            static_cast<std::uint32_t>(start),
+            static_cast<std::uint32_t>(m_position - start),
+            m_fileId,
+            atom
+        };
     }
 
-    ErrorCode ReadOctal(int *res, int minDigits = 1, int maxDigits = -1);
-    ErrorCode ReadHex(int *res, int minDigits = 1, int maxDigits = -1);
-
-    ErrorCode ParseEscapedChar(int *res);
-
-    /// @brief Parse a single word token (identifier or keyword)
-    Token GetWord();
-
-    /// @brief Parse a single number token
-    Token GetNumber();
-
-    /// @brief Parse a character literal token
-    Token GetChar();
-
-    /// @brief Parse a string literal token.
-    Token GetString();
-
-    /// @brief Parse a special (symbol) token.
-    Token GetSpecial();
+    /// @brief Finish an identifier or reserved word, giving it its atom.
+    Token Word(size_t start) const;
 
     /// @brief Read a token from the input stream, regardless of backlog state.
     Token GetTokenRaw();
@@ -97,10 +73,16 @@ private:
     /// @brief Read a token from the backlog or input stream.
     Token GetToken();
 
+    friend class TokenBuffer;
+
 public:
     /* constructor */ Lexer(const std::string &filename = "");
+    /* constructor */ Lexer(const PSourceBuffer &source);
     virtual ~Lexer(void);
 
+    /// @brief The source text being scanned.
+    const PSourceBuffer &Source() const { return m_source; }
+
     /// @brief The current token being processed by the parser.
     const Token &Current() const { return m_current; }
 
@@ -111,7 +93,7 @@ public:
     void PushBack(const Token &);
 
     /// @brief Flag indicating if we've reached the ned of the input stream.
-    bool EndOfFile(void) const { return m_eof; }
+    bool EndOfFile(void) const { return m_position >= m_size; }
 
     /// @brief Returns the next token in the stream.
     Token Get();
@@ -0,0 +1,380 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#ifndef OS_LEXTABLE_H__
+#define OS_LEXTABLE_H__
+
+/*************************************************************************/
+
+#include "token.h"
+
+/*************************************************************************/
+/**
+ * @brief Tables for the lexer's token recognising state machine.
+ *
+ * @details
+ * Every byte is first mapped to a character class, then the pair of
+ * (state, class) is looked up to find the next state.  Values at or past
+ * FirstFinal are not states but finish the token; Finals[] says what type
+ * it is and whether the character that ended it is part of it.
+ *
+ * White space and the bodies of comments are skipped outside of the
+ * state machine, see scan.h.
+ */
+namespace lextable
+{
+    /****************************************************************/
+
+    enum Class : std::uint8_t
+    {
+        C_Other = 0,
+        C_End,       // NUL, only treated as the end if it is past the text.
+        C_Newline,
+        C_Alpha,     // Letters (other than below) and '_'
+        C_Esc,       // n r t v: escape letters that are not hex digits
+        C_HexEsc,    // a b e f: both hex digits and escape letters
+        C_Hex,       // c d A-F
+        C_X,         // x
+        C_Oct,       // 0-7
+        C_Dec,       // 8-9
+        C_Quote,     // "
+        C_Apos,      // '
+        C_Question,  // ?
+        C_Backslash,
+        C_Eq,        // =
+        C_Bang,      // !
+        C_Lt,        // <
+        C_Gt,        // >
+        C_Amp,       // &
+        C_Pipe,      // |
+        C_Star,      // *
+        C_Slash,     // /
+
+        ClassCount
+    };
+
+    /****************************************************************/
+
+    enum State : std::uint8_t
+    {
+        S_Start = 0,
+        S_Word,
+        S_Number,
+
+        S_Eq,
+        S_Bang,
+        S_Lt,
+        S_Gt,
+        S_Amp,
+        S_Pipe,
+        S_Star,
+        S_Slash,
+
+        S_CharOpen,  // Just read the opening quote
+        S_CharBody,  // Have the character, expecting the closing quote
+        S_CharEsc,
+        S_CharOct1,  // Read one/two octal digits of an escape.
+        S_CharOct2,
+        S_CharHex0,  // Read "\x", need at least one hex digit.
+        S_CharHex,
+
+        S_StrBody,
+        S_StrEsc,
+        S_StrOct1,
+        S_StrOct2,
+        S_StrHex0,
+        S_StrHex,
+
+        StateCount
+    };
+
+    /****************************************************************/
+
+    enum Final : std::uint8_t
+    {
+        F_Single = StateCount, // The first character on its own.
+        F_SingleTake,          // As above, consuming the current character.
+        F_Ident,
+        F_Int,
+        F_Char,
+        F_String,
+        F_Equality,
+        F_NotEqual,
+        F_LessEqual,
+        F_LeftShift,
+        F_GreatEqual,
+        F_RightShift,
+        F_LogicalAnd,
+        F_LogicalOr,
+        F_CommentEnd,
+        F_EolComment,
+        F_CommentStart,
+        F_Error,
+
+        FinalLimit
+    };
+
+    constexpr std::uint8_t FirstFinal = StateCount;
+
+    /****************************************************************/
+
+    struct FinalInfo
+    {
+        /// @brief Token type; Null means the type is the first character.
+        Token::Type type;
+
+        /// @brief True if the character that ended the token is part of it.
+        bool consume;
+    };
+
+    constexpr std::array<FinalInfo, FinalLimit - FirstFinal> Finals =
+    {{
+        { Token::Type::Null         , false }, // F_Single
+        { Token::Type::Null         , true  }, // F_SingleTake
+        { Token::Type::IDENT        , false }, // F_Ident
+        { Token::Type::INT_CONST    , false }, // F_Int
+        { Token::Type::CHAR_CONST   , true  }, // F_Char
+        { Token::Type::STR_CONST    , true  }, // F_String
+        { Token::Type::Equality     , true  }, // F_Equality
+        { Token::Type::NotEqual     , true  }, // F_NotEqual
+        { Token::Type::LessEqual    , true  }, // F_LessEqual
+        { Token::Type::LeftShift    , true  }, // F_LeftShift
+        { Token::Type::GreatEqual   , true  }, // F_GreatEqual
+        { Token::Type::RightShift   , true  }, // F_RightShift
+        { Token::Type::LogicalAnd   , true  }, // F_LogicalAnd
+        { Token::Type::LogicalOr    , true  }, // F_LogicalOr
+        { Token::Type::COMMENT_END  , true  }, // F_CommentEnd
+        { Token::Type::EOL_COMMENT  , true  }, // F_EolComment
+        { Token::Type::COMMENT_START, true  }, // F_CommentStart
+        { Token::Type::ERROR        , false }, // F_Error
+    }};
+
+    /****************************************************************/
+
+    constexpr std::array<std::uint8_t, 256> BuildClasses()
+    {
+        std::array<std::uint8_t, 256> rval = {};
+
+        for (int c = 'A'; c <= 'Z'; ++c)
+        {
+            rval[c] = (c <= 'F') ? C_Hex : C_Alpha;
+            rval[c + 0x20] = C_Alpha;
+        }
+
+        for (char c : { 'a', 'b', 'e', 'f' })
+            rval[c] = C_HexEsc;
+
+        for (char c : { 'c', 'd' })
+            rval[c] = C_Hex;
+
+        for (char c : { 'n', 'r', 't', 'v' })
+            rval[c] = C_Esc;
+
+        for (int c = '0'; c <= '9'; ++c)
+            rval[c] = (c <= '7') ? C_Oct : C_Dec;
+
+        rval['_'] = C_Alpha;
+        rval['x'] = C_X;
+        rval[0] = C_End;
+        rval['\n'] = C_Newline;
+        rval['"'] = C_Quote;
+        rval['\''] = C_Apos;
+        rval['?'] = C_Question;
+        rval['\\'] = C_Backslash;
+        rval['='] = C_Eq;
+        rval['!'] = C_Bang;
+        rval['<'] = C_Lt;
+        rval['>'] = C_Gt;
+        rval['&'] = C_Amp;
+        rval['|'] = C_Pipe;
+        rval['*'] = C_Star;
+        rval['/'] = C_Slash;
+
+        return rval;
+    }
+
+    constexpr std::array<std::uint8_t, 256> Classes = BuildClasses();
+
+    /****************************************************************/
+
+    typedef std::array<std::array<std::uint8_t, ClassCount>, StateCount> TransitionTable;
+
+    constexpr TransitionTable BuildTransitions()
+    {
+        TransitionTable t = {};
+
+        auto row = [&t] (State s, std::uint8_t otherwise) -> std::array<std::uint8_t, ClassCount> &
+        {
+            t[s].fill(otherwise);
+            return t[s];
+        };
+
+        auto letters = [] (std::array<std::uint8_t, ClassCount> &r, std::uint8_t to)
+        {
+            for (Class c : { C_Alpha, C_Esc, C_HexEsc, C_Hex, C_X })
+                r[c] = to;
+        };
+
+        auto digits = [] (std::array<std::uint8_t, ClassCount> &r, std::uint8_t to)
+        {
+            r[C_Oct] = to;
+            r[C_Dec] = to;
+        };
+
+        // Start of a token, white space has already been skipped.
+        auto &start = row(S_Start, F_SingleTake);
+        letters(start, S_Word);
+        digits(start, S_Number);
+        start[C_Apos] = S_CharOpen;
+        start[C_Quote] = S_StrBody;
+        start[C_Eq] = S_Eq;
+        start[C_Bang] = S_Bang;
+        start[C_Lt] = S_Lt;
+        start[C_Gt] = S_Gt;
+        start[C_Amp] = S_Amp;
+        start[C_Pipe] = S_Pipe;
+        start[C_Star] = S_Star;
+        start[C_Slash] = S_Slash;
+
+        auto &word = row(S_Word, F_Ident);
+        letters(word, S_Word);
+        digits(word, S_Word);
+
+        auto &number = row(S_Number, F_Int);
+        digits(number, S_Number);
+
+        // Operators that may be followed by a second character.
+        row(S_Eq  , F_Single)[C_Eq   ] = F_Equality;
+        row(S_Bang, F_Single)[C_Eq   ] = F_NotEqual;
+        row(S_Amp , F_Single)[C_Amp  ] = F_LogicalAnd;
+        row(S_Pipe, F_Single)[C_Pipe ] = F_LogicalOr;
+        row(S_Star, F_Single)[C_Slash] = F_CommentEnd;
+
+        auto &lt = row(S_Lt, F_Single);
+        lt[C_Eq] = F_LessEqual;
+        lt[C_Lt] = F_LeftShift;
+
+        auto &gt = row(S_Gt, F_Single);
+        gt[C_Eq] = F_GreatEqual;
+        gt[C_Gt] = F_RightShift;
+
+        auto &slash = row(S_Slash, F_Single);
+        slash[C_Slash] = F_EolComment;
+        slash[C_Star] = F_CommentStart;
+
+        /*
+         * Character and string literals share the same escape handling, they
+         * only differ in where they go once the escape is complete.
+         */
+        auto literal = [&] (State body, State esc, State oct1, State oct2, State hex0, State hex)
+        {
+            auto &e = row(esc, F_Error);
+
+            for (Class c : { C_Esc, C_HexEsc, C_Quote, C_Apos, C_Question, C_Backslash })
+                e[c] = body;
+
+            e[C_Oct] = oct1;
+            e[C_X] = hex0;
+
+            // Up to three octal digits, anything else carries on as in the body.
+            t[oct1] = t[body];
+            t[oct1][C_Oct] = oct2;
+
+            t[oct2] = t[body];
+            t[oct2][C_Oct] = body;
+
+            auto &h0 = row(hex0, F_Error);
+            h0[C_HexEsc] = h0[C_Hex] = hex;
+            digits(h0, hex);
+
+            t[hex] = t[body];
+            t[hex][C_HexEsc] = t[hex][C_Hex] = hex;
+            digits(t[hex], hex);
+        };
+
+        auto &charOpen = row(S_CharOpen, S_CharBody);
+        charOpen[C_End] = charOpen[C_Newline] = F_Error;
+        charOpen[C_Backslash] = S_CharEsc;
+        charOpen[C_Apos] = F_Char; // '' is the NUL character.
+
+        auto &charBody = row(S_CharBody, F_Error);
+        charBody[C_Apos] = F_Char;
+
+        literal(S_CharBody, S_CharEsc, S_CharOct1, S_CharOct2, S_CharHex0, S_CharHex);
+
+        auto &strBody = row(S_StrBody, S_StrBody);
+        strBody[C_End] = strBody[C_Newline] = F_Error;
+        strBody[C_Backslash] = S_StrEsc;
+        strBody[C_Quote] = F_String;
+
+        literal(S_StrBody, S_StrEsc, S_StrOct1, S_StrOct2, S_StrHex0, S_StrHex);
+
+        return t;
+    }
+
+    constexpr TransitionTable Transitions = BuildTransitions();
+
+    /****************************************************************/
+
+    /// @brief Run the tables over a NUL terminated string, for compile time checks.
+    constexpr Token::Type Recognise(std::string_view text, size_t *length = nullptr)
+    {
+        std::uint8_t state = S_Start;
+        size_t pos = 0;
+
+        for (;;)
+        {
+            std::uint8_t cls = pos < text.size() ? Classes[static_cast<std::uint8_t>(text[pos])] : std::uint8_t(C_End);
+            std::uint8_t next = Transitions[state][cls];
+
+            if (next >= FirstFinal)
+            {
+                const FinalInfo &info = Finals[next - FirstFinal];
+
+                if (length)
+                    *length = pos + (info.consume ? 1 : 0);
+
+                return info.type == Token::Type::Null ? static_cast<Token::Type>(text[0]) : info.type;
+            }
+
+            state = next;
+            ++pos;
+        }
+    }
+
+    constexpr bool Check(std::string_view text, Token::Type type, size_t length)
+    {
+        size_t got = 0;
+        return Recognise(text, &got) == type && got == length;
+    }
+
+    static_assert(
+        Check("==", Token::Type::Equality, 2) &&
+        Check("=x", Token::Type::Assignment, 1) &&
+        Check("<<", Token::Type::LeftShift, 2) &&
+        Check(">=", Token::Type::GreatEqual, 2) &&
+        Check("&&", Token::Type::LogicalAnd, 2) &&
+        Check("|", Token::Type::Pipe, 1) &&
+        Check("//", Token::Type::EOL_COMMENT, 2) &&
+        Check("/*", Token::Type::COMMENT_START, 2) &&
+        Check("*/", Token::Type::COMMENT_END, 2) &&
+        Check("x_1+", Token::Type::IDENT, 3) &&
+        Check("123a", Token::Type::INT_CONST, 3) &&
+        Check("'a'", Token::Type::CHAR_CONST, 3) &&
+        Check("''", Token::Type::CHAR_CONST, 2) &&
+        Check("'\\101'", Token::Type::CHAR_CONST, 6) &&
+        Check("'\\x4f'", Token::Type::CHAR_CONST, 6) &&
+        Check("'ab'", Token::Type::ERROR, 2) &&
+        Check("\"a\\n\\\"b\"", Token::Type::STR_CONST, 8) &&
+        Check("\"a\\q\"", Token::Type::ERROR, 3) &&
+        Check("\"abc", Token::Type::ERROR, 4),
+        "Lexer state tables do not recognise tokens as expected.");
+
+    /****************************************************************/
+}
+
+/*************************************************************************/
+
+#endif /* OS_LEXTABLE_H__ */
+
+/*************************************************************************/
@@ -94,7 +94,7 @@ llvm::Type *CodeGen::TranslateType(ast::PReferenceNode node)
         //return llvm::Type::getStringTy(*m_context);
 
     default:
-        std::string errMsg = fmt::format("BUG: Unsupported type: {0}", ident.literal);
+        std::string errMsg = fmt::format("BUG: Unsupported type: {0}", ident.literal());
         throw std::runtime_error(errMsg);
     }
 }
@@ -122,7 +122,7 @@ void CodeGen::Visit(ast::PReferenceNode node)
 
 void CodeGen::Visit(ast::PConstantExpressionNode node)
 {
-    const std::string &literal = node->GetToken().literal;
+    std::string literal(node->GetToken().literal());
     
     PSymbol resultType = node->GetResultType();
     
@@ -541,7 +541,7 @@ void CodeGen::Visit(ast::PFunctionNode node)
     {
         auto parameter = params[i++];
         Token ident = parameter->GetIdent();
-        arg.setName(ident.literal);
+        arg.setName(llvm::StringRef(ident.literal()));
 
         parameter->codeGen = &arg;
     }
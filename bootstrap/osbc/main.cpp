@@ -5,6 +5,7 @@
 
 #include "lex.h"
 #include "parse.h"
+#include "tokbuf.h"
 #include "declarer.h"
 #include "resolver.h"
 
@@ -45,8 +46,10 @@ void ParseArgs(int argc, char **argv)
 
 ast::PModuleNode ParseFile()
 {
-    PLexer lexer(new Lexer(g_filename));
-    Parser parser(lexer);
+    ThreadPool pool;
+
+    auto tokens = TokenBuffer::Create(SourceBuffer::Open(g_filename), pool);
+    Parser parser(tokens);
 
     return parser.Execute();
 }
@@ -52,10 +52,10 @@ void Resolver::ResolveBase(std::shared_ptr<ast::DeclNode> node)
         Token ident = node->GetIdent();
 
         throw compile_error(
-            ident.lineNumber,
+            ident.lineNumber(),
             "Undeclared type '{0}' for '{1}'",
             typeRef->ToString(),
-            ident.literal
+            ident.literal()
         );
     }
 }
@@ -88,7 +88,7 @@ void Resolver::Visit(ast::PModuleNode node)
 
 void Resolver::Visit(ast::PReferenceNode node)
 {
-    fmt::println("ReferenceNode: {0} {1}", node->GetLineNumber(), node->GetIdent().literal);
+    fmt::println("ReferenceNode: {0} {1}", node->GetLineNumber(), node->GetIdent().literal());
     (void)node;
 }
 
@@ -369,7 +369,7 @@ void Resolver::Visit(ast::PReturnStatementNode node)
                 node->GetLineNumber(),
                 "Return type {0} for function '{1}' differs from declared type '{2}'",
                 resultType->name(),
-                m_currentFun->GetIdent().literal,
+                m_currentFun->GetIdent().literal(),
                 returnType->name()
             );
         }
@@ -382,7 +382,7 @@ void Resolver::Visit(ast::PReturnStatementNode node)
                 node->GetLineNumber(),
                 "Return requires {0} value for function '{1}'",
                 returnType->name(),
-                m_currentFun->GetIdent().literal
+                m_currentFun->GetIdent().literal()
             );
         }
     }
@@ -477,7 +477,7 @@ void Resolver::Visit(ast::PFunctionNode node)
                 throw compile_error(
                     node->GetLineNumber(),
                     "Function '{0}' requires return statement.",
-                    node->GetIdent().literal
+                    node->GetIdent().literal()
                 );
             }
         }
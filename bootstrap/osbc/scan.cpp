@@ -0,0 +1,320 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#include "bootstrap.h"
+#include "scan.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+# define OSBC_SCAN_X86 1
+# include <immintrin.h>
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+# define OSBC_TARGET(X_)
+# define OSBC_CTZ(X_) _tzcnt_u32(X_)
+#else
+# define OSBC_TARGET(X_) __attribute__((target(X_)))
+# define OSBC_CTZ(X_) __builtin_ctz(X_)
+#endif
+
+/*************************************************************************/
+
+namespace
+{
+    /****************************************************************/
+    // Plain C++ versions, also used to finish off the tail of the vector versions.
+    /****************************************************************/
+
+    inline bool IsSpace(char c)
+    {
+        return c == ' ' || (static_cast<uchar>(c - '\t') <= ('\r' - '\t'));
+    }
+
+    inline bool IsIdent(char c)
+    {
+        return
+            (static_cast<uchar>((c | 0x20) - 'a') <= ('z' - 'a')) ||
+            (static_cast<uchar>(c - '0') <= 9) ||
+            (c == '_');
+    }
+
+    const char *SkipWhiteSpaceScalar(const char *p, const char *end)
+    {
+        while (p < end && IsSpace(*p))
+            ++p;
+
+        return p;
+    }
+
+    const char *SkipIdentCharsScalar(const char *p, const char *end)
+    {
+        while (p < end && IsIdent(*p))
+            ++p;
+
+        return p;
+    }
+
+    const char *FindCommentEndScalar(const char *p, const char *end)
+    {
+        for (; p + 1 < end; ++p)
+        {
+            if (p[0] == '*' && p[1] == '/')
+                return p;
+        }
+
+        return end;
+    }
+
+#if OSBC_SCAN_X86
+
+    /****************************************************************/
+    // SSE2, 16 bytes at a time.
+    /****************************************************************/
+
+    /// @brief Mask of bytes in the unsigned range [lo, lo + len].
+    inline __m128i InRange128(__m128i v, char lo, char len)
+    {
+        __m128i x = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+        return _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(len)), x);
+    }
+
+    inline __m128i SpaceMask128(__m128i v)
+    {
+        return _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+            InRange128(v, '\t', '\r' - '\t'));
+    }
+
+    inline __m128i IdentMask128(__m128i v)
+    {
+        __m128i alpha = InRange128(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z' - 'a');
+        __m128i digit = InRange128(v, '0', 9);
+        __m128i under = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+
+        return _mm_or_si128(_mm_or_si128(alpha, digit), under);
+    }
+
+    const char *SkipWhiteSpaceSSE2(const char *p, const char *end)
+    {
+        while (p + 16 <= end)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            uint stop = ~static_cast<uint>(_mm_movemask_epi8(SpaceMask128(v))) & 0xFFFF;
+
+            if (stop)
+                return p + OSBC_CTZ(stop);
+
+            p += 16;
+        }
+
+        return SkipWhiteSpaceScalar(p, end);
+    }
+
+    const char *SkipIdentCharsSSE2(const char *p, const char *end)
+    {
+        while (p + 16 <= end)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            uint stop = ~static_cast<uint>(_mm_movemask_epi8(IdentMask128(v))) & 0xFFFF;
+
+            if (stop)
+                return p + OSBC_CTZ(stop);
+
+            p += 16;
+        }
+
+        return SkipIdentCharsScalar(p, end);
+    }
+
+    const char *FindCommentEndSSE2(const char *p, const char *end)
+    {
+        // Compare the '*' lanes against the '/' lanes shifted along by one.
+        while (p + 17 <= end)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 1));
+
+            __m128i hit = _mm_and_si128(
+                _mm_cmpeq_epi8(a, _mm_set1_epi8('*')),
+                _mm_cmpeq_epi8(b, _mm_set1_epi8('/')));
+
+            uint mask = static_cast<uint>(_mm_movemask_epi8(hit));
+
+            if (mask)
+                return p + OSBC_CTZ(mask);
+
+            p += 16;
+        }
+
+        return FindCommentEndScalar(p, end);
+    }
+
+    /****************************************************************/
+    // AVX2, 32 bytes at a time.
+    /****************************************************************/
+
+    OSBC_TARGET("avx2")
+    inline __m256i InRange256(__m256i v, char lo, char len)
+    {
+        __m256i x = _mm256_sub_epi8(v, _mm256_set1_epi8(lo));
+        return _mm256_cmpeq_epi8(_mm256_min_epu8(x, _mm256_set1_epi8(len)), x);
+    }
+
+    OSBC_TARGET("avx2")
+    const char *SkipWhiteSpaceAVX2(const char *p, const char *end)
+    {
+        while (p + 32 <= end)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+
+            __m256i space = _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                InRange256(v, '\t', '\r' - '\t'));
+
+            uint stop = ~static_cast<uint>(_mm256_movemask_epi8(space));
+
+            if (stop)
+                return p + OSBC_CTZ(stop);
+
+            p += 32;
+        }
+
+        return SkipWhiteSpaceSSE2(p, end);
+    }
+
+    OSBC_TARGET("avx2")
+    const char *SkipIdentCharsAVX2(const char *p, const char *end)
+    {
+        while (p + 32 <= end)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+
+            __m256i alpha = InRange256(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z' - 'a');
+            __m256i digit = InRange256(v, '0', 9);
+            __m256i under = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+
+            __m256i ident = _mm256_or_si256(_mm256_or_si256(alpha, digit), under);
+
+            uint stop = ~static_cast<uint>(_mm256_movemask_epi8(ident));
+
+            if (stop)
+                return p + OSBC_CTZ(stop);
+
+            p += 32;
+        }
+
+        return SkipIdentCharsSSE2(p, end);
+    }
+
+    OSBC_TARGET("avx2")
+    const char *FindCommentEndAVX2(const char *p, const char *end)
+    {
+        while (p + 33 <= end)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 1));
+
+            __m256i hit = _mm256_and_si256(
+                _mm256_cmpeq_epi8(a, _mm256_set1_epi8('*')),
+                _mm256_cmpeq_epi8(b, _mm256_set1_epi8('/')));
+
+            uint mask = static_cast<uint>(_mm256_movemask_epi8(hit));
+
+            if (mask)
+                return p + OSBC_CTZ(mask);
+
+            p += 32;
+        }
+
+        return FindCommentEndSSE2(p, end);
+    }
+
+    /****************************************************************/
+
+    bool HasAVX2()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+
+        __cpuid(info, 0);
+
+        if (info[0] < 7)
+            return false;
+
+        __cpuid(info, 1);
+
+        // The OS must also save the YMM registers for us.
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+
+        if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+#endif /* OSBC_SCAN_X86 */
+
+    /****************************************************************/
+
+    struct Scanner
+    {
+        const char *name;
+        const char *(*skipWhiteSpace)(const char *, const char *);
+        const char *(*skipIdentChars)(const char *, const char *);
+        const char *(*findCommentEnd)(const char *, const char *);
+    };
+
+    Scanner Select()
+    {
+#if OSBC_SCAN_X86
+        if (HasAVX2())
+            return { "avx2", SkipWhiteSpaceAVX2, SkipIdentCharsAVX2, FindCommentEndAVX2 };
+
+# if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        return { "sse2", SkipWhiteSpaceSSE2, SkipIdentCharsSSE2, FindCommentEndSSE2 };
+# endif
+#endif
+
+        return { "scalar", SkipWhiteSpaceScalar, SkipIdentCharsScalar, FindCommentEndScalar };
+    }
+
+    const Scanner s_scanner = Select();
+}
+
+/*************************************************************************/
+
+const char *scan::SkipWhiteSpace(const char *p, const char *end)
+{
+    return s_scanner.skipWhiteSpace(p, end);
+}
+
+/*************************************************************************/
+
+const char *scan::SkipIdentChars(const char *p, const char *end)
+{
+    return s_scanner.skipIdentChars(p, end);
+}
+
+/*************************************************************************/
+
+const char *scan::FindCommentEnd(const char *p, const char *end)
+{
+    return s_scanner.findCommentEnd(p, end);
+}
+
+/*************************************************************************/
+
+const char *scan::Implementation()
+{
+    return s_scanner.name;
+}
+
+/*************************************************************************/
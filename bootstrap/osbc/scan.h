@@ -0,0 +1,39 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#ifndef OS_SCAN_H__
+#define OS_SCAN_H__
+
+/*************************************************************************/
+
+#include "bootstrap.h"
+
+/*************************************************************************/
+/**
+ * @brief Bulk character scanning used by the lexer.
+ *
+ * @details
+ * Each function scans forward from p and never looks at or past end.  The
+ * widest implementation the CPU supports (AVX2, SSE2 or plain C++) is
+ * picked the first time any of them is called.
+ */
+namespace scan
+{
+    /// @brief Skip white space (as isspace() in the "C" locale), returns the first other character.
+    const char *SkipWhiteSpace(const char *p, const char *end);
+
+    /// @brief Skip identifier characters [A-Za-z0-9_], returns the first other character.
+    const char *SkipIdentChars(const char *p, const char *end);
+
+    /// @brief Find the "*" of the next "*/" pair, returns end if there is none.
+    const char *FindCommentEnd(const char *p, const char *end);
+
+    /// @brief Name of the implementation in use, E.g. "avx2".
+    const char *Implementation();
+}
+
+/*************************************************************************/
+
+#endif /* OS_SCAN_H__ */
+
+/*************************************************************************/
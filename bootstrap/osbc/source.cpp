@@ -0,0 +1,277 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#include "bootstrap.h"
+#include "source.h"
+
+#include <cstring>
+#include <deque>
+#include <shared_mutex>
+#include <sstream>
+
+#include <fmt/format.h>
+
+#if !defined(_WIN32)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+# define OSBC_HAVE_MMAP 1
+#endif
+
+/*************************************************************************/
+/*************************************************************************/
+
+namespace
+{
+    // Spellings used by Token::Builtin()
+    const char s_builtinText[] = "void bool char int string";
+}
+
+/*************************************************************************/
+
+struct SourceBuffer::Registry
+{
+    std::shared_mutex lock;
+    std::deque<PSourceBuffer> buffers;
+};
+
+/*************************************************************************/
+
+SourceBuffer::Registry &SourceBuffer::GetRegistry()
+{
+    // Never freed; tokens can still be formatted while statics are torn down.
+    static Registry *s_registry = [] ()
+    {
+        auto registry = new Registry();
+        auto builtin = std::make_shared<SourceBuffer>(private_tag__(), "<builtin>");
+
+        builtin->m_data = s_builtinText;
+        builtin->m_size = sizeof(s_builtinText) - 1;
+
+        registry->buffers.push_back(builtin);
+        return registry;
+    }();
+
+    return *s_registry;
+}
+
+/*************************************************************************/
+/*************************************************************************/
+
+SourceBuffer::SourceBuffer(private_tag__, std::string_view name)
+    : m_id(BuiltinId)
+    , m_name(name)
+    , m_data("")
+    , m_size(0)
+    , m_mapping(nullptr)
+    , m_mappingSize(0)
+    , m_storage()
+    , m_linesBuilt()
+    , m_lineStarts()
+{
+}
+
+SourceBuffer::~SourceBuffer()
+{
+#if OSBC_HAVE_MMAP
+    if (m_mapping)
+        munmap(m_mapping, m_mappingSize);
+#endif
+}
+
+/*************************************************************************/
+
+PSourceBuffer SourceBuffer::Open(const std::string &filename)
+{
+    if (filename.empty())
+    {
+        auto rval = std::make_shared<SourceBuffer>(private_tag__(), "<stdin>");
+        rval->Read(std::cin);
+        return Register(rval);
+    }
+
+    auto rval = std::make_shared<SourceBuffer>(private_tag__(), filename);
+
+    if (rval->Map(filename))
+        return Register(rval);
+
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+
+    if (file.fail())
+        throw std::runtime_error(fmt::format("Unable to open file '{0}' for reading.", filename));
+
+    rval->Read(file);
+
+    return Register(rval);
+}
+
+/*************************************************************************/
+
+PSourceBuffer SourceBuffer::FromString(std::string_view name, std::string_view text)
+{
+    auto rval = std::make_shared<SourceBuffer>(private_tag__(), name);
+
+    rval->m_storage = text;
+    rval->m_data = rval->m_storage.c_str();
+    rval->m_size = rval->m_storage.size();
+
+    return Register(rval);
+}
+
+/*************************************************************************/
+
+PSourceBuffer SourceBuffer::Register(PSourceBuffer buffer)
+{
+    if (buffer->m_size > MaxSize)
+        throw std::runtime_error(fmt::format("Source file '{0}' is too large.", buffer->m_name));
+
+    Registry &registry = GetRegistry();
+    std::unique_lock lock(registry.lock);
+
+    buffer->m_id = static_cast<std::uint32_t>(registry.buffers.size());
+    registry.buffers.push_back(buffer);
+
+    return buffer;
+}
+
+/*************************************************************************/
+
+const SourceBuffer &SourceBuffer::Get(std::uint32_t id)
+{
+    Registry &registry = GetRegistry();
+    std::shared_lock lock(registry.lock);
+
+    if (id < registry.buffers.size())
+        return *registry.buffers[id];
+
+    throw std::logic_error(fmt::format("BUG: Unknown source buffer id {0}", id));
+}
+
+/*************************************************************************/
+/**
+ * @brief Try to memory map the named file.
+ *
+ * @details
+ * The lexer relies on a NUL following the text.  The kernel zero fills the
+ * tail of the last mapped page, so that holds for free unless the file is
+ * an exact multiple of the page size; in that case (or if mapping fails
+ * for any reason) we return false and the caller falls back to a read.
+ */
+bool SourceBuffer::Map(const std::string &filename)
+{
+#if OSBC_HAVE_MMAP
+    int fd = open(filename.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    auto closeFile = defer([fd] () { close(fd); });
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+        return false;
+
+    size_t size = static_cast<size_t>(st.st_size);
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    if ((size % pageSize) == 0)
+        return false;
+
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    m_mapping = mapping;
+    m_mappingSize = size;
+    m_data = static_cast<const char *>(mapping);
+    m_size = size;
+
+    return true;
+#else
+    (void)filename;
+    return false;
+#endif
+}
+
+/*************************************************************************/
+
+void SourceBuffer::Read(std::istream &input)
+{
+    std::ostringstream text;
+    text << input.rdbuf();
+
+    m_storage = std::move(text).str();
+    m_data = m_storage.c_str();
+    m_size = m_storage.size();
+}
+
+/*************************************************************************/
+
+void SourceBuffer::BuildLineTable() const
+{
+    std::call_once(m_linesBuilt, [this] ()
+    {
+        m_lineStarts.push_back(0);
+
+        const char *end = m_data + m_size;
+
+        for (const char *p = m_data; p < end; ++p)
+        {
+            p = static_cast<const char *>(memchr(p, '\n', end - p));
+
+            if (!p)
+                break;
+
+            m_lineStarts.push_back((p - m_data) + 1);
+        }
+    });
+}
+
+/*************************************************************************/
+
+size_t SourceBuffer::LineCount() const
+{
+    BuildLineTable();
+    return m_lineStarts.size();
+}
+
+/*************************************************************************/
+
+size_t SourceBuffer::LineStart(int lineNumber) const
+{
+    BuildLineTable();
+
+    if (lineNumber < 1)
+        return 0;
+
+    size_t idx = static_cast<size_t>(lineNumber - 1);
+
+    return idx < m_lineStarts.size() ? m_lineStarts[idx] : m_size;
+}
+
+/*************************************************************************/
+
+int SourceBuffer::LineNumber(size_t offset) const
+{
+    BuildLineTable();
+
+    auto itr = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+
+    return static_cast<int>(itr - m_lineStarts.begin());
+}
+
+/*************************************************************************/
+
+int SourceBuffer::ColumnNumber(size_t offset) const
+{
+    int line = LineNumber(offset);
+
+    return static_cast<int>(offset - m_lineStarts[line - 1]) + 1;
+}
+
+/*************************************************************************/
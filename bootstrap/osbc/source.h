@@ -0,0 +1,133 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#ifndef OS_SOURCE_H__
+#define OS_SOURCE_H__
+
+/*************************************************************************/
+
+#include "bootstrap.h"
+
+#include <mutex>
+
+/*************************************************************************/
+
+typedef std::shared_ptr<class SourceBuffer> PSourceBuffer;
+
+/**
+ * @brief The complete text of a single source file.
+ *
+ * @details
+ * The whole input is held as one contiguous buffer so the lexer can scan
+ * it without copying it line by line.  Files are memory mapped where the
+ * platform allows it; standard input (and anything we cannot map) is read
+ * in with a single bulk read instead.
+ *
+ * The buffer is always followed by a NUL byte, so the lexer can peek one
+ * character past the end without a bounds check.
+ *
+ * Line and column numbers are not tracked while scanning.  A table of line
+ * start offsets is built the first time a line or column is asked for.
+ *
+ * Every buffer is registered under a small numeric id when it is created
+ * and is kept alive for the rest of the compilation; tokens refer back to
+ * their text through that id.
+ */
+class SourceBuffer
+{
+private:
+    // Remove copy/move constructors
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer(SourceBuffer &&) = delete;
+
+    const SourceBuffer &operator =(const SourceBuffer &) = delete;
+    const SourceBuffer &operator =(SourceBuffer &&) = delete;
+
+private:
+    struct private_tag__ { explicit private_tag__() = default; };
+
+    std::uint32_t m_id;
+    std::string m_name;
+
+    const char *m_data;
+    size_t m_size;
+
+    void *m_mapping;         // Base of the memory mapped view, if any.
+    size_t m_mappingSize;
+
+    std::string m_storage;   // Owned copy when the input was read in bulk.
+
+    mutable std::once_flag m_linesBuilt;
+    mutable std::vector<size_t> m_lineStarts;
+
+    void BuildLineTable() const;
+
+    struct Registry;
+    static Registry &GetRegistry();
+
+    static PSourceBuffer Register(PSourceBuffer buffer);
+
+    bool Map(const std::string &filename);
+    void Read(std::istream &input);
+
+public:
+    /// @brief Id of the buffer that holds compiler supplied text.
+    static constexpr std::uint32_t BuiltinId = 0;
+
+    /// @brief Largest source we can address with 32 bit token offsets.
+    static constexpr size_t MaxSize = 0xFFFF'FFFF;
+
+    /* constructor */ SourceBuffer(private_tag__, std::string_view name);
+    virtual ~SourceBuffer();
+
+    /**
+     * @brief Load an entire file.
+     *
+     * @details
+     * An empty filename reads all of standard input.
+     */
+    static PSourceBuffer Open(const std::string &filename);
+
+    /// @brief Create a buffer over a copy of the given text.
+    static PSourceBuffer FromString(std::string_view name, std::string_view text);
+
+    /// @brief Look up a registered buffer by its id.
+    static const SourceBuffer &Get(std::uint32_t id);
+
+    /// @brief The id this buffer is registered under.
+    std::uint32_t Id() const { return m_id; }
+
+    /// @brief Name of the file (or "<stdin>") the text came from.
+    const std::string &Name() const { return m_name; }
+
+    /// @brief Start of the text; always followed by a NUL byte.
+    const char *Data() const { return m_data; }
+
+    /// @brief Number of bytes of text, not counting the trailing NUL.
+    size_t Size() const { return m_size; }
+
+    std::string_view Text() const { return std::string_view(m_data, m_size); }
+
+    std::string_view Text(size_t offset, size_t length) const
+    {
+        return std::string_view(m_data + offset, length);
+    }
+
+    /// @brief Number of lines in the buffer (builds the line table).
+    size_t LineCount() const;
+
+    /// @brief Offset of the first character on the given one based line.
+    size_t LineStart(int lineNumber) const;
+
+    /// @brief One based line number that contains the given offset.
+    int LineNumber(size_t offset) const;
+
+    /// @brief One based column of the given offset within its line.
+    int ColumnNumber(size_t offset) const;
+};
+
+/*************************************************************************/
+
+#endif /* OS_SOURCE_H__ */
+
+/*************************************************************************/
@@ -1,155 +1,158 @@
-/*************************************************************************/
-/*************************************************************************/
-
-#ifndef OS_SYMBOL_H__
-#define OS_SYMBOL_H__
-
-/*************************************************************************/
-
-#include <string>
-#include <memory>
-#include <map>
-
-#include "token.h"
-
-/*************************************************************************/
-
-typedef std::shared_ptr<class Symbol> PSymbol;
-
-class SymbolTable;
-
-/*************************************************************************/
-
-class Symbol
-{
-public:
-    enum class UseType
-    {
-        Invalid,
-        Function,
-        Variable,
-        Parameter, // Like variable but may have special in/out/ref handling.
-        Primitive, // Built in type: int, float, double, etc.
-        Label,
-        Struct, // Value based type
-        Enum,
-        Set
-    };
-
-private:
-    friend SymbolTable;
-
-    std::vector<PSymbol> m_parameters;
-    SymbolTable *m_parent;
-    int m_index;
-    std::string m_name;
-
-    /* constructor */ Symbol(SymbolTable *parent, int index, const std::string &name)
-        : m_parameters()
-        , m_parent(parent)
-        , m_index(index)
-        , m_name(name)
-        , lineNumber(0)
-        , useType(UseType::Invalid)
-        , passBy(PassByType::Default)
-        , exporting(false)
-        , isConst(false)
-        , isSpecial(false)
-        , baseType()
-        , constType()
-        , constLiteral()
-        , codeGen(nullptr)
-    {
-    }
-
-public:
-    // Get the symbol table that manages this symbol.
-    SymbolTable &Parent() const { return *m_parent; }
-
-    int index() const { return m_index; }
-
-    /// @brief Returns true if this is a global variable or not.
-    bool isGlobal() const;
-
-    // The literal name of the symbol
-    const std::string &name() const { return m_name; }
-
-    /// @brief Get a list of parameters defined on this symbol.
-    std::vector<PSymbol> GetParameters() const { return m_parameters; }
-
-    // Add a parameter to this symbol.
-    void AddParameter(PSymbol symbol) { m_parameters.push_back(symbol); }
-
-    /// @brief The line number the symbol was defined on.
-    int lineNumber;
-
-    // The type of symbol defined.
-    UseType useType;
-
-    // How a parameter is passed if this is a parameter variable.
-    PassByType passBy;
-
-    // Set if this symbol is to be exported from the module.
-    bool exporting;
-
-    // Set if this symbol is a constant.
-    bool isConst;
-
-    // Set if this symbol is generated by the compiler.
-    bool isSpecial;
-
-    // Symbol's base type (if any)
-    // Return type for function declarations.
-    PSymbol baseType;
-
-    // Type of parsed constant literal.
-    Token::Type constType;
-
-    // String of the actual constant literal.
-    std::string constLiteral;
-
-    // Opaque pointer for code generation.
-    void *codeGen;
-};
-
-/*************************************************************************/
-
-/**
- * @brief Checks if supplied symbol type is a type that can be used in a declaration.
- */
-constexpr bool isTypeUseType(Symbol::UseType useType)
-{
-    return
-        (useType == Symbol::UseType::Primitive) ||
-        (useType == Symbol::UseType::Struct) ||
-        (useType == Symbol::UseType::Enum) ||
-        (useType == Symbol::UseType::Set)
-    ;
-}
-
-/*************************************************************************/
-
-template <>
-struct fmt::formatter<Symbol::UseType> : formatter<string_view>
-{
-    auto format(Symbol::UseType useType, format_context &ctx) const
-        -> format_context::iterator;
-};
-
-/*************************************************************************/
-
-template <>
-struct fmt::formatter<Symbol> : formatter<string_view>
-{
-    auto format(const Symbol &symbol, format_context &ctx) const
-        -> format_context::iterator
-    {
-        return formatter<string_view>::format(symbol.name(), ctx);
-    }
-};
-
-/*************************************************************************/
-
-#endif /* OS_SYMBOL_H__ */
-
-/*************************************************************************/
+/*************************************************************************/
+/*************************************************************************/
+
+#ifndef OS_SYMBOL_H__
+#define OS_SYMBOL_H__
+
+/*************************************************************************/
+
+#include <string>
+#include <memory>
+#include <map>
+
+#include "token.h"
+
+/*************************************************************************/
+
+typedef std::shared_ptr<class Symbol> PSymbol;
+
+class SymbolTable;
+
+/*************************************************************************/
+
+class Symbol
+{
+public:
+    enum class UseType
+    {
+        Invalid,
+        Function,
+        Variable,
+        Parameter, // Like variable but may have special in/out/ref handling.
+        Primitive, // Built in type: int, float, double, etc.
+        Label,
+        Struct, // Value based type
+        Enum,
+        Set
+    };
+
+private:
+    friend SymbolTable;
+
+    std::vector<PSymbol> m_parameters;
+    SymbolTable *m_parent;
+    int m_index;
+    Atom m_name;
+
+    /* constructor */ Symbol(SymbolTable *parent, int index, Atom name)
+        : m_parameters()
+        , m_parent(parent)
+        , m_index(index)
+        , m_name(name)
+        , lineNumber(0)
+        , useType(UseType::Invalid)
+        , passBy(PassByType::Default)
+        , exporting(false)
+        , isConst(false)
+        , isSpecial(false)
+        , baseType()
+        , constType()
+        , constLiteral()
+        , codeGen(nullptr)
+    {
+    }
+
+public:
+    // Get the symbol table that manages this symbol.
+    SymbolTable &Parent() const { return *m_parent; }
+
+    int index() const { return m_index; }
+
+    /// @brief Returns true if this is a global variable or not.
+    bool isGlobal() const;
+
+    // The interned name of the symbol
+    Atom atom() const { return m_name; }
+
+    // The literal name of the symbol
+    std::string_view name() const { return AtomTable::Text(m_name); }
+
+    /// @brief Get a list of parameters defined on this symbol.
+    std::vector<PSymbol> GetParameters() const { return m_parameters; }
+
+    // Add a parameter to this symbol.
+    void AddParameter(PSymbol symbol) { m_parameters.push_back(symbol); }
+
+    /// @brief The line number the symbol was defined on.
+    int lineNumber;
+
+    // The type of symbol defined.
+    UseType useType;
+
+    // How a parameter is passed if this is a parameter variable.
+    PassByType passBy;
+
+    // Set if this symbol is to be exported from the module.
+    bool exporting;
+
+    // Set if this symbol is a constant.
+    bool isConst;
+
+    // Set if this symbol is generated by the compiler.
+    bool isSpecial;
+
+    // Symbol's base type (if any)
+    // Return type for function declarations.
+    PSymbol baseType;
+
+    // Type of parsed constant literal.
+    Token::Type constType;
+
+    // String of the actual constant literal.
+    std::string constLiteral;
+
+    // Opaque pointer for code generation.
+    void *codeGen;
+};
+
+/*************************************************************************/
+
+/**
+ * @brief Checks if supplied symbol type is a type that can be used in a declaration.
+ */
+constexpr bool isTypeUseType(Symbol::UseType useType)
+{
+    return
+        (useType == Symbol::UseType::Primitive) ||
+        (useType == Symbol::UseType::Struct) ||
+        (useType == Symbol::UseType::Enum) ||
+        (useType == Symbol::UseType::Set)
+    ;
+}
+
+/*************************************************************************/
+
+template <>
+struct fmt::formatter<Symbol::UseType> : formatter<string_view>
+{
+    auto format(Symbol::UseType useType, format_context &ctx) const
+        -> format_context::iterator;
+};
+
+/*************************************************************************/
+
+template <>
+struct fmt::formatter<Symbol> : formatter<string_view>
+{
+    auto format(const Symbol &symbol, format_context &ctx) const
+        -> format_context::iterator
+    {
+        return formatter<string_view>::format(symbol.name(), ctx);
+    }
+};
+
+/*************************************************************************/
+
+#endif /* OS_SYMBOL_H__ */
+
+/*************************************************************************/
@@ -24,47 +24,67 @@ SymbolTable::SymbolTable(PSymbolTable parent)
 
 /*************************************************************************/
 
-PSymbol SymbolTable::Find(const std::string &name, Scoping scoping /* = Scoping::Normal */) const
+PSymbol SymbolTable::Find(Atom name, Scoping scoping /* = Scoping::Normal */) const
 {
-    auto itr = m_symbols.find(name);
+    for (const SymbolTable *table = this; table; table = table->m_parent.get())
+    {
+        auto itr = table->m_symbols.find(name);
 
-    if (itr != m_symbols.end())
-        return itr->second;
+        if (itr != table->m_symbols.end())
+            return itr->second;
 
-    if (scoping != Scoping::LocalOnly && m_parent)
-        return m_parent->Find(name, scoping);
+        if (scoping == Scoping::LocalOnly)
+            break;
+    }
 
     return nullptr;
 }
 
 /*************************************************************************/
 
+PSymbol SymbolTable::Find(std::string_view name, Scoping scoping /* = Scoping::Normal */) const
+{
+    // A name that was never interned can't have been declared.
+    Atom atom = AtomTable::Find(name);
+
+    return atom != AtomTable::NullAtom ? Find(atom, scoping) : nullptr;
+}
+
+/*************************************************************************/
+
 PSymbol SymbolTable::Find(ast::PReferenceNode reference, Scoping scoping /* = Scoping::Normal */) const
 {
     // TODO: Support more complex names.
-    return Find(reference->GetIdent().literal, scoping);
+    return Find(reference->GetAtom(), scoping);
 }
 
 /*************************************************************************/
 
-PSymbol SymbolTable::Add(const std::string &ident)
+PSymbol SymbolTable::Add(Atom ident)
 {
     int index = static_cast<int>(m_symbols.size());
 
     PSymbol rval = std::shared_ptr<Symbol>(new Symbol(this, index, ident));
 
-    m_symbols[ident] = rval;
+    m_symbols.insert_or_assign(ident, rval);
 
     return rval;
 }
 
 /*************************************************************************/
 
+PSymbol SymbolTable::Add(std::string_view ident)
+{
+    return Add(AtomTable::Intern(ident));
+}
+
+/*************************************************************************/
+
 PSymbol SymbolTable::Add(const Token &ident)
 {
-    PSymbol rval = Add(ident.literal);
+    PSymbol rval = Add(ident.atom);
 
-    rval->lineNumber = ident.lineNumber;
+    rval->lineNumber = ident.lineNumber();
 
     return rval;
 }
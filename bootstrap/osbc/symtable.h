@@ -6,6 +6,8 @@
 
 /*************************************************************************/
 
+#include <unordered_map>
+
 #include "ast.h"
 #include "symbol.h"
 
@@ -30,7 +32,7 @@ class SymbolTable
 {
 private:
     PSymbolTable m_parent;
-    std::map<std::string, PSymbol> m_symbols;
+    std::unordered_map<Atom, PSymbol> m_symbols;
 
 public:
     /* constructor */ SymbolTable();
@@ -42,10 +44,12 @@ public:
     bool IsEmpty() const { return m_symbols.empty(); }
 
     // Find a symbol in the current SymbolTable scope.
-    PSymbol Find(const std::string &ident, Scoping scoping = Scoping::Normal) const;
+    PSymbol Find(Atom ident, Scoping scoping = Scoping::Normal) const;
+    PSymbol Find(std::string_view ident, Scoping scoping = Scoping::Normal) const;
     PSymbol Find(ast::PReferenceNode reference, Scoping scoping = Scoping::Normal) const;
 
-    PSymbol Add(const std::string &ident);
+    PSymbol Add(Atom ident);
+    PSymbol Add(std::string_view ident);
     PSymbol Add(const Token &ident);
 };
 
@@ -0,0 +1,84 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#include "bootstrap.h"
+#include "threadpool.h"
+
+/*************************************************************************/
+/*************************************************************************/
+
+ThreadPool::ThreadPool(size_t threads /* = 0 */)
+    : m_size(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+    , m_threads()
+    , m_lock()
+    , m_wake()
+    , m_queue()
+    , m_stopping(false)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_lock);
+        m_stopping = true;
+    }
+
+    m_wake.notify_all();
+
+    for (auto &thread : m_threads)
+        thread.join();
+}
+
+/*************************************************************************/
+
+void ThreadPool::Start()
+{
+    m_threads.reserve(m_size);
+
+    for (size_t i = 0; i < m_size; ++i)
+        m_threads.emplace_back([this] () { Run(); });
+}
+
+/*************************************************************************/
+
+void ThreadPool::Enqueue(std::function<void ()> job)
+{
+    {
+        std::lock_guard lock(m_lock);
+
+        if (m_threads.empty())
+            Start();
+
+        m_queue.push_back(std::move(job));
+    }
+
+    m_wake.notify_one();
+}
+
+/*************************************************************************/
+
+void ThreadPool::Run()
+{
+    for (;;)
+    {
+        std::function<void ()> job;
+
+        {
+            std::unique_lock lock(m_lock);
+
+            m_wake.wait(lock, [this] () { return m_stopping || !m_queue.empty(); });
+
+            // Drain the queue before stopping.
+            if (m_queue.empty())
+                return;
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        job();
+    }
+}
+
+/*************************************************************************/
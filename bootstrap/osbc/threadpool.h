@@ -0,0 +1,82 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#ifndef OS_THREADPOOL_H__
+#define OS_THREADPOOL_H__
+
+/*************************************************************************/
+
+#include "bootstrap.h"
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+/*************************************************************************/
+/**
+ * @brief A fixed set of worker threads that run queued jobs.
+ *
+ * @details
+ * The threads are not started until the first job is submitted, so a pool
+ * that is never used costs nothing.  Destroying the pool waits for every
+ * queued job to finish.
+ */
+class ThreadPool
+{
+private:
+    // Remove copy/move constructors
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool(ThreadPool &&) = delete;
+
+    const ThreadPool &operator =(const ThreadPool &) = delete;
+    const ThreadPool &operator =(ThreadPool &&) = delete;
+
+private:
+    size_t m_size;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::deque<std::function<void ()>> m_queue;
+    bool m_stopping;
+
+    void Start();
+    void Run();
+
+    void Enqueue(std::function<void ()> job);
+
+public:
+    /**
+     * @brief Create a pool with the given number of threads.
+     *
+     * @details
+     * Zero uses one thread per hardware thread.
+     */
+    /* constructor */ ThreadPool(size_t threads = 0);
+    virtual ~ThreadPool();
+
+    /// @brief Number of worker threads.
+    size_t Size() const { return m_size; }
+
+    /// @brief Queue a job, the future gets its result (or exception).
+    template <typename TFunc>
+    auto Submit(TFunc func) -> std::future<std::invoke_result_t<TFunc>>
+    {
+        typedef std::invoke_result_t<TFunc> TResult;
+
+        auto task = std::make_shared<std::packaged_task<TResult ()>>(std::move(func));
+        auto rval = task->get_future();
+
+        Enqueue([task] () { (*task)(); });
+
+        return rval;
+    }
+};
+
+/*************************************************************************/
+
+#endif /* OS_THREADPOOL_H__ */
+
+/*************************************************************************/
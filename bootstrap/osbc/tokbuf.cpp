@@ -0,0 +1,224 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#include "bootstrap.h"
+#include "tokbuf.h"
+
+#include <cstring>
+
+/*************************************************************************/
+/*************************************************************************/
+
+TokenBuffer::TokenBuffer(private_tag__, const PSourceBuffer &source)
+    : m_source(source)
+    , m_fileId(source->Id())
+    , m_types()
+    , m_offsets()
+    , m_lengths()
+    , m_atoms()
+{
+}
+
+TokenBuffer::~TokenBuffer()
+{
+}
+
+/*************************************************************************/
+
+PTokenBuffer TokenBuffer::Create(Lexer &lexer)
+{
+    auto rval = std::make_shared<TokenBuffer>(private_tag__(), lexer.Source());
+
+    // Rough guess from typical sources, saves most of the regrowing.
+    rval->Reserve((lexer.m_size - lexer.m_position) / 4 + 1);
+
+    // Anything the lexer has already read ahead comes first.
+    if (lexer.m_current.type != Token::Type::Null && lexer.m_current.type != Token::Type::UNKNOWN)
+        rval->Push(lexer.m_current);
+
+    if (lexer.m_lookAhead.type != Token::Type::Null && lexer.m_lookAhead.type != Token::Type::UNKNOWN)
+        rval->Push(lexer.m_lookAhead);
+
+    while (rval->m_types.empty() || rval->m_types.back() != Token::Type::EndOfFile)
+        rval->Push(lexer.GetToken());
+
+    lexer.m_current = lexer.m_lookAhead = rval->At(rval->Count() - 1);
+
+    rval->m_source->LineCount(); // Build the line table now.
+
+    return rval;
+}
+
+/*************************************************************************/
+
+PTokenBuffer TokenBuffer::Create(const PSourceBuffer &source)
+{
+    Lexer lexer(source);
+    return Create(lexer);
+}
+
+/*************************************************************************/
+/**
+ * @details
+ * The source is cut into chunks just after newlines.  No token but a block
+ * comment can run across a newline (string and character literals stop
+ * at the end of the line), so each chunk is lexed on its own on the
+ * guess that it does not start inside a block comment.
+ *
+ * The guesses are then checked in order.  The lexer carries no state from
+ * one token to the next, so if a chunk has a token starting exactly where
+ * the previous chunk really left off, everything it lexed from there on
+ * is right.  Otherwise the chunk started inside a comment that threw it
+ * out of step, and just that chunk is lexed again from the right place.
+ */
+PTokenBuffer TokenBuffer::Create(const PSourceBuffer &source, ThreadPool &pool)
+{
+    const char *data = source->Data();
+    size_t size = source->Size();
+    size_t chunkCount = std::min(pool.Size() * 4, size / MinChunkSize);
+
+    if (size < ParallelThreshold || pool.Size() < 2 || chunkCount < 2)
+        return Create(source);
+
+    std::vector<size_t> bounds = { 0 };
+
+    for (size_t i = 1; i < chunkCount; ++i)
+    {
+        size_t split = size * i / chunkCount;
+
+        if (split <= bounds.back())
+            continue;
+
+        auto eol = static_cast<const char *>(memchr(data + split, '\n', size - split));
+
+        if (!eol)
+            break;
+
+        size_t bound = (eol - data) + 1;
+
+        if (bound > bounds.back() && bound < size)
+            bounds.push_back(bound);
+    }
+
+    bounds.push_back(size);
+
+    struct Chunk
+    {
+        PTokenBuffer tokens;
+        Token next;
+    };
+
+    auto lines = pool.Submit([source] () { source->LineCount(); });
+
+    std::vector<std::future<Chunk>> pending;
+
+    for (size_t i = 0; i + 1 < bounds.size(); ++i)
+    {
+        size_t start = bounds[i];
+        size_t limit = bounds[i + 1];
+
+        pending.push_back(pool.Submit([source, start, limit] ()
+        {
+            Chunk chunk;
+            Lexer lexer(source);
+
+            lexer.m_position = start;
+
+            chunk.tokens = std::make_shared<TokenBuffer>(private_tag__(), source);
+            chunk.tokens->Reserve((limit - start) / 4 + 1);
+            chunk.next = chunk.tokens->LexRange(lexer, limit);
+
+            return chunk;
+        }));
+    }
+
+    auto rval = std::make_shared<TokenBuffer>(private_tag__(), source);
+    rval->Reserve(size / 4 + 1);
+
+    Token next; // Where the previous chunk really stopped.
+
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        Chunk chunk = pending[i].get();
+
+        if (i == 0)
+        {
+            rval->Append(*chunk.tokens, 0);
+            next = chunk.next;
+            continue;
+        }
+
+        // A block comment (or the end of the file) covers the whole chunk.
+        if (next.offset >= bounds[i + 1])
+            continue;
+
+        size_t first = chunk.tokens->FindOffset(next.offset);
+
+        if (first < chunk.tokens->Count())
+        {
+            rval->Append(*chunk.tokens, first);
+            next = chunk.next;
+        }
+        else
+        {
+            Lexer lexer(source);
+            lexer.m_position = next.offset;
+
+            next = rval->LexRange(lexer, bounds[i + 1]);
+        }
+    }
+
+    rval->Push(next); // Always the end of file.
+    lines.get();
+
+    return rval;
+}
+
+/*************************************************************************/
+
+void TokenBuffer::Reserve(size_t count)
+{
+    m_types.reserve(count);
+    m_offsets.reserve(count);
+    m_lengths.reserve(count);
+    m_atoms.reserve(count);
+}
+
+/*************************************************************************/
+
+void TokenBuffer::Append(const TokenBuffer &other, size_t from)
+{
+    m_types.insert(m_types.end(), other.m_types.begin() + from, other.m_types.end());
+    m_offsets.insert(m_offsets.end(), other.m_offsets.begin() + from, other.m_offsets.end());
+    m_lengths.insert(m_lengths.end(), other.m_lengths.begin() + from, other.m_lengths.end());
+    m_atoms.insert(m_atoms.end(), other.m_atoms.begin() + from, other.m_atoms.end());
+}
+
+/*************************************************************************/
+
+size_t TokenBuffer::FindOffset(std::uint32_t offset) const
+{
+    auto itr = std::lower_bound(m_offsets.begin(), m_offsets.end(), offset);
+
+    if (itr == m_offsets.end() || *itr != offset)
+        return Count();
+
+    return itr - m_offsets.begin();
+}
+
+/*************************************************************************/
+
+Token TokenBuffer::LexRange(Lexer &lexer, size_t limit)
+{
+    for (;;)
+    {
+        Token token = lexer.GetToken();
+
+        if (token.type == Token::Type::EndOfFile || token.offset >= limit)
+            return token;
+
+        Push(token);
+    }
+}
+
+/*************************************************************************/
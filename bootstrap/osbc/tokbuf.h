@@ -0,0 +1,123 @@
+/*************************************************************************/
+/*************************************************************************/
+
+#ifndef OS_TOKBUF_H__
+#define OS_TOKBUF_H__
+
+/*************************************************************************/
+
+#include "bootstrap.h"
+#include "lex.h"
+#include "threadpool.h"
+#include "token.h"
+
+/*************************************************************************/
+
+typedef std::shared_ptr<class TokenBuffer> PTokenBuffer;
+
+/**
+ * @brief Every token of a source file, lexed up front.
+ *
+ * @details
+ * The tokens are held as parallel arrays of types, offsets, lengths and
+ * atoms rather than as an array of Token, so walking the types (which is
+ * most of what the parser does) only touches one dense array.  Tokens are
+ * addressed by index; looking ahead or backing up is just index
+ * arithmetic.
+ *
+ * The last token is always EndOfFile, and any index past the end reads
+ * as that token.  The source's line start table is built along with the
+ * tokens so line numbers never have to be worked out lazily mid parse.
+ */
+class TokenBuffer
+{
+private:
+    // Remove copy/move constructors
+    TokenBuffer(const TokenBuffer &) = delete;
+    TokenBuffer(TokenBuffer &&) = delete;
+
+    const TokenBuffer &operator =(const TokenBuffer &) = delete;
+    const TokenBuffer &operator =(TokenBuffer &&) = delete;
+
+private:
+    struct private_tag__ { explicit private_tag__() = default; };
+
+    PSourceBuffer m_source;
+    std::uint32_t m_fileId;
+
+    std::vector<Token::Type> m_types;
+    std::vector<std::uint32_t> m_offsets;
+    std::vector<std::uint32_t> m_lengths;
+    std::vector<Atom> m_atoms;
+
+    void Push(const Token &token)
+    {
+        m_types.push_back(token.type);
+        m_offsets.push_back(token.offset);
+        m_lengths.push_back(token.length);
+        m_atoms.push_back(token.atom);
+    }
+
+    size_t Clamp(size_t index) const
+    {
+        return index < m_types.size() ? index : m_types.size() - 1;
+    }
+
+    void Reserve(size_t count);
+
+    /// @brief Copy tokens from another buffer, starting at the given index.
+    void Append(const TokenBuffer &other, size_t from);
+
+    /// @brief Index of the token starting at offset, or Count() if there is none.
+    size_t FindOffset(std::uint32_t offset) const;
+
+    /// @brief Lex tokens that start before limit, returns the first one that doesn't.
+    Token LexRange(Lexer &lexer, size_t limit);
+
+public:
+    /// @brief Sources smaller than this are always lexed on one thread.
+    static constexpr size_t ParallelThreshold = 4 * 1024 * 1024;
+
+    /// @brief Smallest piece of a source handed to one thread.
+    static constexpr size_t MinChunkSize = 1024 * 1024;
+
+    /* constructor */ TokenBuffer(private_tag__, const PSourceBuffer &source);
+    virtual ~TokenBuffer();
+
+    /// @brief Lex all of the remaining tokens from the lexer.
+    static PTokenBuffer Create(Lexer &lexer);
+
+    /// @brief Lex an entire source buffer.
+    static PTokenBuffer Create(const PSourceBuffer &source);
+
+    /**
+     * @brief Lex an entire source buffer, large ones in parallel.
+     *
+     * @details
+     * The result is the same as Create(source).  Only the numbering of any
+     * atoms first seen here depends on which thread got to them first.
+     */
+    static PTokenBuffer Create(const PSourceBuffer &source, ThreadPool &pool);
+
+    const PSourceBuffer &Source() const { return m_source; }
+
+    /// @brief Number of tokens, including the final EndOfFile.
+    size_t Count() const { return m_types.size(); }
+
+    Token::Type TypeAt(size_t index) const { return m_types[Clamp(index)]; }
+
+    /// @brief Rebuild the full token at the given index.
+    Token At(size_t index) const
+    {
+        index = Clamp(index);
+        return Token { m_types[index], m_offsets[index], m_lengths[index], m_fileId, m_atoms[index] };
+    }
+
+    int LineNumber(size_t index) const { return m_source->LineNumber(m_offsets[Clamp(index)]); }
+};
+
+/*************************************************************************/
+
+#endif /* OS_TOKBUF_H__ */
+
+/*************************************************************************/
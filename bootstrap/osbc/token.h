@@ -7,6 +7,8 @@
 /*************************************************************************/
 
 #include "bootstrap.h"
+#include "atoms.h"
+#include "source.h"
 
 /*************************************************************************/
 /**
@@ -134,57 +136,72 @@ struct Token
         UNKNOWN       = 0xFFFF'FF01, // Unknown token encountered?
     };
 
-    int lineNumber;
-    std::string literal;
-    Type type;
+    /*
+     * Tokens are small handles into their source text rather than owning a
+     * copy of it, so they can be copied around freely.  The text a token
+     * refers to lives for as long as the compilation does.
+     */
 
-    Token()
-        : lineNumber(0)
-        , literal()
-        , type(Type::UNKNOWN)
-    {
-    }
+    /// @brief What kind of token this is.
+    Type type = Type::UNKNOWN;
 
-    Token(int ln, std::string_view l, Type t)
-        : lineNumber(ln)
-        , literal(l)
-        , type(t)
-    {
-    }
+    /// @brief Byte offset of the token's text within its source.
+    std::uint32_t offset = 0;
+
+    /// @brief Length of the token's text in bytes.
+    std::uint32_t length = 0;
+
+    /// @brief Source buffer the token came from (see SourceBuffer::Get())
+    std::uint32_t fileId = SourceBuffer::BuiltinId;
 
-    Token(const Token &rhs)
-        : lineNumber(rhs.lineNumber)
-        , literal(rhs.literal)
-        , type(rhs.type)
+    /// @brief Interned name for identifiers and reserved words, otherwise NullAtom.
+    Atom atom = AtomTable::NullAtom;
+
+    /// @brief Create a token for compiler supplied text such as "void".
+    static Token Builtin(Type type, std::string_view text)
     {
+        const SourceBuffer &builtin = SourceBuffer::Get(SourceBuffer::BuiltinId);
+        size_t offset = builtin.Text().find(text);
+
+        ASSERT(offset != std::string_view::npos, "Unknown builtin token text");
+
+        return Token
+        {
+            type,
+            static_cast<std::uint32_t>(offset),
+            static_cast<std::uint32_t>(text.size()),
+            SourceBuffer::BuiltinId,
+            AtomTable::Intern(text)
+        };
     }
 
-    Token(Token &&rhs) noexcept
-        : lineNumber(std::move(rhs.lineNumber))
-        , literal(std::move(rhs.literal))
-        , type(std::move(rhs.type))
+    /// @brief The text of the token.
+    std::string_view literal() const
     {
+        return SourceBuffer::Get(fileId).Text(offset, length);
     }
 
-    const Token &operator =(const Token &rhs)
+    /// @brief The line the token starts on, or -1 for builtin tokens.
+    int lineNumber() const
     {
-        lineNumber = rhs.lineNumber;
-        literal = rhs.literal;
-        type = rhs.type;
+        if (fileId == SourceBuffer::BuiltinId)
+            return -1;
 
-        return *this;
+        return SourceBuffer::Get(fileId).LineNumber(offset);
     }
 
-    const Token &operator =(Token &&rhs) noexcept
+    /// @brief The column the token starts at, or -1 for builtin tokens.
+    int columnNumber() const
     {
-        lineNumber = std::move(rhs.lineNumber);
-        literal = std::move(rhs.literal);
-        type = std::move(rhs.type);
+        if (fileId == SourceBuffer::BuiltinId)
+            return -1;
 
-        return *this;
+        return SourceBuffer::Get(fileId).ColumnNumber(offset);
     }
 };
 
+static_assert(std::is_trivially_copyable<Token>::value, "Tokens must stay cheap to copy.");
+
 /*************************************************************************/
 
 template <>
@@ -240,6 +257,8 @@ struct fmt::formatter<Token::Type> : fmt::formatter<std::string>
         case Token::Type::INTERFACE: name = "interface"; break;
 
         // Multi character tokens
+        case Token::Type::LogicalOr    : name = "\"||\""; break;
+        case Token::Type::LogicalAnd   : name = "\"&&\""; break;
         case Token::Type::Equality     : name = "\"==\""; break;
         case Token::Type::NotEqual     : name = "\"!=\""; break;
         case Token::Type::GreatEqual   : name = "\">=\""; break;